@@ -0,0 +1,158 @@
+#include "../lib/dfs-linear-memory.h"
+#include "../lib/strongly-connected-components.h"
+#include <pthread.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * Generate a random graph in the sorted representation, where the degree of each vertex is uniformly distributed in
+ * [0, 2 * degree]. The same arguments always generate the same graph.
+ */
+std::vector<int> generate_graph(int n, int degree) {
+    std::mt19937 generator(0xdeadbeef);
+    std::uniform_int_distribution<int> random_degree(0, std::min(2 * degree, n - 1));
+    std::uniform_int_distribution<int> random_vertex(1, n);
+
+    std::vector<std::vector<int>> adjacency(n);
+    int m = 0;
+    for (auto &neighbours : adjacency) {
+        std::set<int> unique;
+        for (int i = random_degree(generator); (int) unique.size() < i;)
+            unique.insert(random_vertex(generator));
+
+        neighbours = std::vector<int>(unique.begin(), unique.end());
+        m += (int) neighbours.size();
+    }
+
+    std::vector<int> graph{n};
+    for (int v = 0, vertex_index = n + 2; v < n; vertex_index += (int) adjacency[v++].size())
+        graph.push_back(vertex_index);
+
+    graph.push_back(m);
+    for (auto &neighbours : adjacency)
+        graph.insert(graph.end(), neighbours.begin(), neighbours.end());
+
+    return graph;
+}
+
+/**
+ * Find the strongly connected components using Tarjan's algorithm on top of the linear memory DFS.
+ * The low links are only updated when a vertex is closed, since the DFS doesn't report the edges it follows.
+ *
+ * @return The number of strongly connected components.
+ */
+int tarjan(std::vector<int> &graph, std::vector<int> &components) {
+    int n = vertices(graph);
+    std::vector<int> index(n), low(n), stack;
+    std::vector<bool> on_stack(n);
+    int next_index = 0, next_component = 0;
+
+    auto pre = [&](int v) {
+        index[v] = low[v] = next_index++;
+        stack.push_back(v);
+        on_stack[v] = true;
+    };
+
+    auto post = [&](int v) {
+        // the children are closed, so their low links are final
+        for (int u : neighbours(graph, v + 1))
+            if (on_stack[u - 1])
+                low[v] = std::min(low[v], low[u - 1]);
+
+        if (low[v] == index[v]) {
+            int u;
+            do {
+                u = stack.back();
+                stack.pop_back();
+                on_stack[u] = false;
+                components[u] = next_component;
+            } while (u != v);
+
+            next_component++;
+        }
+    };
+
+    std::vector<state> states(n, unexplored);
+    for (int v = 0; v < n; v++) {
+        if (states[v] == unexplored) {
+            states[v] = explored;
+            dfs_linear_memory(graph, v, pre, post, states);
+        }
+    }
+
+    return next_component;
+}
+
+/**
+ * Return the number of seconds it takes to run the function.
+ */
+template<class F>
+double measure(F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct arguments {
+    int n, degree, repetitions;
+};
+
+/**
+ * Compare the constant memory algorithms with the linear memory ones on a random graph.
+ */
+void *benchmark(void *data) {
+    auto [n, degree, repetitions] = *(arguments *) data;
+
+    auto graph = generate_graph(n, degree);
+    printf("n = %d, m = %d, %d repetitions\n", n, edges(graph), repetitions);
+
+    std::vector<int> components(n);
+    auto assign = [&components](int v, int c) { components[v] = c; };
+    auto nothing = [](int) {};
+
+    int count_constant = 0, count_linear = 0;
+    double transposition = 0, constant = 0, linear = 0, dfs_constant = 0, dfs_linear = 0;
+    for (int i = 0; i < repetitions; i++) {
+        transposition += measure([&] { transpose(graph); });
+        transposition += measure([&] { transpose(graph); });
+
+        constant += measure([&] { count_constant = strongly_connected_components(graph, assign); });
+        linear += measure([&] { count_linear = tarjan(graph, components); });
+
+        dfs_constant += measure([&] { dfs_constant_memory(graph, 0, nothing, nothing); });
+        dfs_linear += measure([&] { dfs_linear_memory(graph, 0, nothing, nothing); });
+    }
+
+    printf("transpose:                       %8.3f s\n", transposition / (2 * repetitions));
+    printf("SCC (Kosaraju, constant memory): %8.3f s (%d components)\n", constant / repetitions, count_constant);
+    printf("SCC (Tarjan, linear memory):     %8.3f s (%d components)\n", linear / repetitions, count_linear);
+    printf("DFS (constant memory):           %8.3f s\n", dfs_constant / repetitions);
+    printf("DFS (linear memory):             %8.3f s\n", dfs_linear / repetitions);
+
+    return nullptr;
+}
+
+/**
+ * Usage: benchmarks_run [vertices] [average degree] [repetitions]
+ */
+int main(int argc, char **argv) {
+    arguments args{
+            argc > 1 ? atoi(argv[1]) : 200000,
+            argc > 2 ? atoi(argv[2]) : 10,
+            argc > 3 ? atoi(argv[3]) : 3,
+    };
+
+    // the linear memory DFS is recursive and the DFS paths of random graphs are long, so give it a large stack
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, (size_t) 1 << 30);
+
+    pthread_t thread;
+    pthread_create(&thread, &attributes, benchmark, &args);
+    pthread_join(thread, nullptr);
+}
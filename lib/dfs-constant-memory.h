@@ -3,19 +3,64 @@
 #include <vector>
 #include "utilities.h"
 #include <iostream>
+#include <cstdlib>
+#include <climits>
+#include <stdexcept>
+#include <type_traits>
 
+/**
+ * An edge callback that ignores all edges.
+ */
+struct ignore_edges {
+    template<class... Args>
+    void operator()(Args...) {}
+};
 
-template<class Pre, class Post>
+/**
+ * The maximum size of a graph (the number of ints in its sorted representation) that the constant memory DFS supports.
+ * The vertices discovered from vertices of degree 1 are marked by values of up to twice the size (see DFS::chain).
+ */
+constexpr std::size_t max_graph_size = INT_MAX / 2;
+
+/**
+ * Throw std::invalid_argument if the graph is larger than max_graph_size.
+ */
+inline void check_graph_size(const std::vector<int> &graph) {
+    if (graph.size() > max_graph_size)
+        throw std::invalid_argument("the graph must have at most INT_MAX / 2 elements");
+}
+
+/**
+ * The DFS on a graph in the swapped representation.
+ *
+ * Besides the vertex callbacks, it reports the edges it follows to white vertices (tree edges) as tree_edge(to, index)
+ * and the edges that lead to grey vertices (back edges) as back_edge(from, to, index). The vertices are indexed from 0
+ * and index is the index of the edge in the sorted representation (counted from the first neighbour of the first
+ * vertex), so it can be used to look up the data of the edge in a payload array.
+ *
+ * Finding the source of a back edge requires iterating its adjacency array, so if back_edge returns a bool, no more back
+ * edges are reported once it returns false.
+ *
+ * A vertex of degree 1 has no second position to move its neighbour to (see prevent_first_position_visit), so the vertex
+ * it discovers marks its parent by storing the start of its adjacency array offset by n + m + 2 instead of a reverse
+ * pointer. The graph must therefore have at most max_graph_size elements (checked by the functions that run the DFS).
+ */
+template<class Pre, class Post, class Back = ignore_edges, class Tree = ignore_edges>
 class DFS {
     std::vector<int> &graph, &T, &A;
     Pre &preprocess;
     Post &postprocess;
+    Back back_edge;
+    Tree tree_edge;
 
     int n, m, v_s;
+    bool report_back_edges = !std::is_same_v<std::remove_cvref_t<Back>, ignore_edges>;
 
 public:
-    DFS(std::vector<int> &_graph, int _v_s, Pre &_preprocess, Post &_postprocess)
-            : graph(_graph), T(_graph), A(_graph), preprocess(_preprocess), postprocess(_postprocess) {
+    DFS(std::vector<int> &_graph, int _v_s, Pre &_preprocess, Post &_postprocess, Back _back_edge = Back(),
+        Tree _tree_edge = Tree())
+            : graph(_graph), T(_graph), A(_graph), preprocess(_preprocess), postprocess(_postprocess),
+              back_edge(_back_edge), tree_edge(_tree_edge) {
         n = vertices(graph);
         m = edges(graph);
         v_s = _v_s;
@@ -25,10 +70,23 @@ public:
      * Return true if the specified vertex is white, else return false.
      */
     inline bool is_white(int v) {
-        return !is_starting(v)  // starting vertex is never white
-               && is_vertex(A[T[v]]);  // degree 2
+        if (is_starting(v) || is_black(v))  // starting vertex is never white
+            return false;
+
+        // a white vertex points to its first neighbour, which is either a sink or the start of an adjacency array
+        return is_vertex(T[v]) || (is_pointer(T[v]) && is_adjacency_start(T[v]));
     }
 
+    /**
+     * Return true if the specified vertex is black (it has been closed), else return false.
+     */
+    inline bool is_black(int v) { return T[v] < 0; }
+
+    /**
+     * Return true if the specified vertex is grey (it is on the current DFS path), else return false.
+     */
+    inline bool is_grey(int v) { return !is_white(v) && !is_black(v); }
+
     /**
      * Return true if the given value can be a name of a vertex (it falls in range).
      */
@@ -39,53 +97,243 @@ public:
      */
     inline bool is_pointer(int v) { return n + 2 <= v && v <= n + m + 2; }
 
+    /**
+     * Return true if the given value marks a vertex discovered from a vertex of degree 1.
+     */
+    inline bool is_chained(int v) { return v > n + m + 2; }
+
+    /**
+     * Return the mark of a vertex discovered from the vertex of degree 1 whose adjacency array starts at index p.
+     */
+    inline int chain(int p) { return p + n + m + 2; }
+
+    /**
+     * Return the start of the adjacency array of the vertex of degree 1 that the marked vertex was discovered from.
+     */
+    inline int unchain(int v) { return v - (n + m + 2); }
+
     /**
      * Return true if the given value is the starting vertex.
      */
     inline bool is_starting(int v) { return v == v_s; }
 
+    /**
+     * Return true if the specified vertex is a sink (it has no neighbours, so it has no adjacency array).
+     */
+    inline bool is_sink(int v) { return std::abs(T[v]) == v; }
+
+    /**
+     * Return true if index p is the start of an adjacency array (it contains the name of a vertex that isn't a sink).
+     */
+    inline bool is_adjacency_start(int p) { return is_vertex(A[p]) && !is_sink(A[p]); }
+
+    /**
+     * Return the name of the vertex a neighbour value refers to (sinks are stored by name, the rest by pointer).
+     */
+    inline int target(int x) { return is_vertex(x) ? x : A[x]; }
+
+    /**
+     * Return true if the vertex whose adjacency array starts at index p has degree 1.
+     */
+    inline bool is_degree_one(int p) { return p + 1 == n + m + 2 || is_adjacency_start(p + 1); }
+
     /**
      * Iterate backwards from index p and return the index of the start of the adjacency array.
      */
     inline int iterate_backwards(int p) {
-        while (is_pointer(A[p])) p--;
+        while (!is_adjacency_start(p)) p--;
         return p;
     }
 
+    /**
+     * Return the index that the first neighbour of the opened vertex v is stored at.
+     *
+     * The starting vertex stores it itself and the other ones at their reverse pointer. Vertices discovered from
+     * vertices of degree 1 store it at the same index as their parent, since the parent no longer needs it.
+     */
+    inline int first_position(int v) {
+        while (!is_starting(v) && is_chained(T[v])) v = A[unchain(T[v])];
+        return is_starting(v) ? v : T[v];
+    }
+
     /**
      * Prevent visiting the first neighbour of A[p] from the first index by visiting first from the second position
      * and then swapping back. (see presentation slide 12).
+     *
+     * @param first The index that the first neighbour of A[p] is stored at (see first_position).
+     */
+    inline void prevent_first_position_visit(int p, int first) { std::swap(A[first], A[p + 1]); }
+
+    /**
+     * Return true if the specified vertex was visited by the last run, else return false.
+     * Only valid between a call to run(false) and a call to restore().
+     */
+    inline bool was_visited(int v) { return is_black(v); }
+
+    /**
+     * Call the function for each vertex (indexed from 0) that was visited by the last run, in increasing order.
+     * Only valid between a call to run(false) and a call to restore().
+     */
+    template<class F>
+    void for_each_visited(F &f) {
+        for (int v = 1; v < n + 1; v++)
+            if (was_visited(v))
+                f(v - 1);
+    }
+
+    /**
+     * Restore the representation, undoing the black marks of the visited vertices.
      */
-    inline void prevent_first_position_visit(int p) {
-        // special case for first vertex - it doesn't have a reverse pointer (we don't have to follow using A[...])
-        if (is_starting(A[p])) std::swap(A[T[p]], A[p + 1]);
-        else std::swap(A[A[T[p]]], A[p + 1]);
+    void restore() {
+        for (int v = 1; v < n + 1; v++)
+            if (is_black(v))
+                T[v] = -T[v];
+    }
+
+    /**
+     * Report the back edge from the vertex from to the vertex to (both indexed from 1).
+     */
+    inline void report_back_edge(int from, int to, int index) {
+        if constexpr (std::is_same_v<std::invoke_result_t<Back &, int, int, int>, bool>)
+            report_back_edges = back_edge(from - 1, to - 1, index);
+        else
+            back_edge(from - 1, to - 1, index);
+    }
+
+    /**
+     * Open and immediately close a sink.
+     */
+    inline void visit_sink(int v) {
+        preprocess(v - 1);
+        T[v] = -T[v];
+        postprocess(v - 1);
     }
 
     /**
      * Run the DFS on the graph.
+     *
+     * @param restore_marks Whether to restore the representation at the end. If false, the visited vertices stay
+     *                      marked and can be queried using was_visited() until restore() is called.
+     */
+    void run(bool restore_marks = true) {
+        if (is_sink(v_s)) {
+            visit_sink(v_s);
+        } else {
+            // find the position of the starting vertex and start the DFS
+            for (int p = n + 2; p < n + m + 2; p++) {
+                if (is_starting(A[p])) {
+                    run_from(p);
+                    break;
+                }
+            }
+        }
+
+        if (restore_marks)
+            restore();
+    }
+
+    /**
+     * Run the DFS from each vertex that hasn't been visited yet (in increasing order), visiting the entire graph.
+     *
+     * @param root A custom user function that is called with each new root of the DFS forest (indexed from 0).
+     * @param restore_marks Whether to restore the representation at the end (see run).
      */
-    void run() {
+    template<class Root>
+    void run_forest(Root &root, bool restore_marks = true) {
+        int p = n + 2;
+        for (int v = 1; v < n + 1; v++) {
+            if (is_sink(v)) {
+                if (!is_black(v)) {
+                    root(v - 1);
+                    run_tree(v, p);
+                }
+
+                continue;
+            }
+
+            // adjacency arrays are sorted, so the start of the next one is the start of v
+            while (!is_adjacency_start(p)) p++;
+
+            if (!is_black(v)) {
+                root(v - 1);
+                run_tree(v, p);
+            }
+
+            p++;
+        }
+
+        if (restore_marks)
+            restore();
+    }
+
+    /**
+     * Run the DFS from the specified vertex, whose adjacency array starts at index p (ignored for sinks).
+     * Already visited vertices are skipped. Leaves the visited vertices marked.
+     */
+    void run_tree(int v, int p) {
+        v_s = v;
+
+        if (is_sink(v)) visit_sink(v);
+        else run_from(p);
+    }
+
+    /**
+     * Run the DFS from the starting vertex, which is at index p. Leaves the visited vertices marked.
+     */
+    void run_from(int p) {
         // variables for transferring states
-        int p;          // the current vertex position
         bool is_first;  // whether it's the first neighbour of a given vertex we're visiting
+        int slot;       // the position of the edge at p in the sorted representation
+        int first;      // the index that the first neighbour of the current vertex is stored at (see first_position)
 
-        // find the position of the starting vertex and start the DFS
-        for (p = n + 2; p < n + m + 2; p++)
-            if (is_starting(A[p]))
-                goto visit;
+        first = A[p];
+        goto visit;
 
         /**
          * Call preprocess and visit the next neighbour.
          */
-        visit: // p
+        visit: // p, first
         {
             preprocess(A[p] - 1);
 
+            if (is_degree_one(p))
+                goto visitOnlyNeighbor;
+
             is_first = true;
             goto nextNeighbor;
         }
 
+        /**
+         * Visit the only neighbour of a vertex of degree 1, which is stored at first.
+         */
+        visitOnlyNeighbor: // p, first
+        {
+            int v = A[p];
+            int index = p - (n + 2);
+
+            if (is_vertex(A[first])) {
+                if (is_white(A[first])) {
+                    tree_edge(A[first] - 1, index);
+                    visit_sink(A[first]);
+                }
+            } else if (is_white(T[A[first]])) {
+                // the discovered vertex stores its first neighbour at first, so it can't store a reverse pointer there
+                // instead, it is marked by the start of the adjacency array of v
+                int q = A[first];
+                int u = A[q];
+                A[first] = T[u];
+                T[u] = chain(p);
+
+                tree_edge(u - 1, index);
+                p = q;
+                goto visit;
+            } else if (report_back_edges && is_grey(T[A[first]])) {
+                report_back_edge(v, T[A[first]], index);
+            }
+
+            goto close;
+        }
+
         /**
          * Main logic for changing vertices.
          */
@@ -94,50 +342,51 @@ public:
             // if we want to visit the first neighbour from the first index, don't
             // @presentation(12)
             if (is_first) {
-                prevent_first_position_visit(p++);
+                prevent_first_position_visit(p++, first);
+                slot = p - 1;
                 goto follow;
             }
 
-            int v = A[p - 2];
-
             // if they're switched (from not wanting to visit the neighbour from the first index), switch them back
             // @presentation(12)
-            if (is_vertex(v) &&
-                ((is_starting(v) && A[T[p - 2]] > A[p - 1]) || (!is_starting(v) && A[A[T[p - 2]]] > A[p - 1]))) {
-                p -= 2;
-                prevent_first_position_visit(p++);
-
-                goto follow;
-            }
+            if (is_adjacency_start(p - 2)) {
+                first = first_position(A[p - 2]);
 
-            // if we went through all the neighbours
-            if (p >= n + m + 2 || is_vertex(A[p])) {
-                // find the name of the vertex that we're currently iterating
-                int q = iterate_backwards(p - 1);
-                int v = A[q];
+                if (target(A[first]) > target(A[p - 1])) {
+                    p -= 2;
+                    prevent_first_position_visit(p++, first);
 
-                // if it's the starting one then we're done
-                if (is_starting(v)) {
-                    T[v]++;
-                    postprocess(v - 1);
-                    goto restore;
+                    slot = p;
+                    goto follow;
                 }
+            }
 
-                // else backtrack
-                p = q;
-                goto backtrack;
+            // if we went through all the neighbours, close the vertex we're currently iterating
+            if (p >= n + m + 2 || is_adjacency_start(p)) {
+                p = iterate_backwards(p - 1);
+                first = first_position(A[p]);
+                goto close;
             }
 
             // attempt to follow pointer at p
+            slot = p;
             goto follow;
         }
 
         /**
          * Follow the pointer stored at p, if it's white; else go to neighbour.
          */
-        follow: // p
+        follow: // p, slot
         {
-            if (is_white(T[A[p]])) {
+            int index = slot - (n + 2);
+
+            // sinks are stored by name and don't need a reverse pointer, since they're closed right away
+            if (is_vertex(A[p])) {
+                if (is_white(A[p])) {
+                    tree_edge(A[p] - 1, index);
+                    visit_sink(A[p]);
+                }
+            } else if (is_white(T[A[p]])) {
                 // @presentation(11)
                 // create a reverse pointer
                 int q = A[p];
@@ -145,26 +394,57 @@ public:
                 A[p] = T[v];
                 T[v] = p;
 
+                tree_edge(v - 1, index);
+                first = p;
                 p = q;
                 goto visit;
-            } else {
-                p++;
-                is_first = false;
-                goto nextNeighbor;
+            } else if (report_back_edges && is_grey(T[A[p]])) {
+                report_back_edge(A[iterate_backwards(p)], T[A[p]], index);
+            }
+
+            p++;
+            is_first = false;
+            goto nextNeighbor;
+        }
+
+        /**
+         * Close the vertex whose adjacency array starts at p, backtracking if it isn't the starting one.
+         */
+        close: // p, first
+        {
+            int v = A[p];
+
+            // if it's the starting one then we're done
+            if (is_starting(v)) {
+                T[v] = -T[v];
+                postprocess(v - 1);
+                return;
             }
+
+            goto backtrack;
         }
 
         /**
          * Backtrack from position p of vertex A[p].
          */
-        backtrack: // p
+        backtrack: // p, first
         {
             // @presentation(13) (care - the names don't match)
             int v = A[p];  // name of the vertex we're backtracking from
             int q = A[v];  // reverse pointer
 
+            // discovered from a vertex of degree 1, which is closed right after it
+            if (is_chained(q)) {
+                T[v] = -A[first];  // negate to mark it black
+                A[first] = p;
+                postprocess(v - 1);
+                p = unchain(q);
+
+                goto close;
+            }
+
             // undo the reverse pointer
-            T[v] = A[q] + 1;  // +1 to mark it grey-black
+            T[v] = -A[q];  // negate to mark it black
             A[q] = p;
             postprocess(v - 1);
             p = q + 1;
@@ -172,15 +452,6 @@ public:
             is_first = false;
             goto nextNeighbor;
         }
-
-        /**
-         * Restore the representation.
-         */
-        restore:
-        {
-            for (int v = 1; v < n + 1; v++)
-                T[v] -= 1;
-        }
     }
 };
 
@@ -191,15 +462,122 @@ public:
  * @param start The starting vertex (indexed from 0).
  * @param preprocess A custom user function that is called each time a vertex is opened.
  * @param postprocess A custom user function that is called each time a vertex is closed.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
  */
 template<class Pre, class Post>
 void dfs_constant_memory(std::vector<int> &graph, int start, Pre &preprocess, Post &postprocess) {
+    ignore_edges tree_edge;
+    dfs_constant_memory(graph, start, preprocess, postprocess, tree_edge);
+}
+
+/**
+ * Run DFS on the provided graph, also reporting the edges that the vertices are discovered by.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param start The starting vertex (indexed from 0).
+ * @param preprocess A custom user function that is called each time a vertex is opened.
+ * @param postprocess A custom user function that is called each time a vertex is closed.
+ * @param tree_edge A custom user function that is called with the vertex (indexed from 0) and the index of the edge
+ *                  (see DFS) each time a vertex is discovered, right before it is opened.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class Pre, class Post, class Tree>
+void dfs_constant_memory(std::vector<int> &graph, int start, Pre &preprocess, Post &postprocess, Tree &tree_edge) {
+    check_graph_size(graph);
     sorted_to_pointer(graph);
     pointer_to_swap(graph);
 
-    DFS<Pre, Post> dfs(graph, start + 1, preprocess, postprocess);
+    DFS<Pre, Post, ignore_edges, Tree &> dfs(graph, start + 1, preprocess, postprocess, ignore_edges(), tree_edge);
     dfs.run();
 
     swap_to_pointer(graph);
     pointer_to_sorted(graph);
 }
+
+
+/**
+ * The result of a DFS with deferred restoration. Until it is restored (explicitly or on destruction), the graph is left
+ * in the swapped representation with the visited vertices marked, so the reachable set can be queried from it.
+ */
+template<class Pre, class Post, class Tree = ignore_edges>
+class DeferredDFS {
+    std::vector<int> &graph;
+    DFS<Pre, Post, ignore_edges, Tree> dfs;
+    bool restored = false;
+
+public:
+    DeferredDFS(std::vector<int> &_graph, int start, Pre &preprocess, Post &postprocess, Tree tree_edge = Tree())
+            : graph(_graph), dfs(_graph, start + 1, preprocess, postprocess, ignore_edges(), tree_edge) {
+        check_graph_size(graph);
+        sorted_to_pointer(graph);
+        pointer_to_swap(graph);
+
+        dfs.run(false);
+    }
+
+    DeferredDFS(const DeferredDFS &) = delete;
+
+    DeferredDFS &operator=(const DeferredDFS &) = delete;
+
+    ~DeferredDFS() { restore(); }
+
+    /**
+     * Return true if the specified vertex (indexed from 0) is reachable from the starting vertex.
+     */
+    bool was_visited(int v) { return !restored && dfs.was_visited(v + 1); }
+
+    /**
+     * Call the function for each vertex (indexed from 0) reachable from the starting vertex, in increasing order.
+     */
+    template<class F>
+    void for_each_visited(F &f) {
+        if (!restored)
+            dfs.for_each_visited(f);
+    }
+
+    /**
+     * Restore the graph to the sorted representation. Does nothing if it has already been restored.
+     */
+    void restore() {
+        if (restored) return;
+
+        dfs.restore();
+        swap_to_pointer(graph);
+        pointer_to_sorted(graph);
+        restored = true;
+    }
+};
+
+/**
+ * Run DFS on the provided graph, deferring the restoration of the graph.
+ * The graph must not be used until the returned object is restored or destroyed.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param start The starting vertex (indexed from 0).
+ * @param preprocess A custom user function that is called each time a vertex is opened.
+ * @param postprocess A custom user function that is called each time a vertex is closed.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class Pre, class Post>
+DeferredDFS<Pre, Post> dfs_constant_memory_deferred(std::vector<int> &graph, int start, Pre &preprocess,
+                                                    Post &postprocess) {
+    return DeferredDFS<Pre, Post>(graph, start, preprocess, postprocess);
+}
+
+/**
+ * Run DFS on the provided graph, deferring the restoration of the graph and reporting the edges that the vertices are
+ * discovered by. The graph must not be used until the returned object is restored or destroyed.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param start The starting vertex (indexed from 0).
+ * @param preprocess A custom user function that is called each time a vertex is opened.
+ * @param postprocess A custom user function that is called each time a vertex is closed.
+ * @param tree_edge A custom user function that is called with the vertex (indexed from 0) and the index of the edge
+ *                  (see DFS) each time a vertex is discovered, right before it is opened.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class Pre, class Post, class Tree>
+DeferredDFS<Pre, Post, Tree &> dfs_constant_memory_deferred(std::vector<int> &graph, int start, Pre &preprocess,
+                                                            Post &postprocess, Tree &tree_edge) {
+    return DeferredDFS<Pre, Post, Tree &>(graph, start, preprocess, postprocess, tree_edge);
+}
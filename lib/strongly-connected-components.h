@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include "dfs-constant-memory.h"
+#include "utilities.h"
+
+/**
+ * Find the strongly connected components of the provided graph using Kosaraju's algorithm: a DFS forest on the graph
+ * to obtain the finishing order, and then a DFS forest on the transposed graph in the reverse of this order.
+ * The graph is transposed in-place. Aside from it, 2n + 1 ints are used: the finishing order of the first pass and the
+ * counters of the transposition (see transpose).
+ *
+ * @param graph The graph in the sorted representation.
+ * @param component A custom user function that is called with each vertex (indexed from 0) and the index of its
+ *                  component. The components are numbered from 0 in the topological order of the condensation.
+ * @param tree_edge A custom user function that is called with the vertex (indexed from 0) and the index of the edge
+ *                  (see DFS) each time a vertex is discovered in the transposed graph, right before it is assigned
+ *                  its component. The edge leads from the vertex in the original graph and the tree edges of each
+ *                  component form a spanning tree of it, with all edges leading to its first vertex.
+ * @param payloads Arrays of data of the edges (see transpose). They are transposed along with the graph, so they are
+ *                 indexed by the indexes reported to tree_edge when it is called, and restored at the end.
+ * @return The number of strongly connected components.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class F, class Tree, class... Payloads>
+int strongly_connected_components(std::vector<int> &graph, F &component, Tree &tree_edge, Payloads &... payloads) {
+    check_graph_size(graph);
+    auto nothing = [](int) {};
+
+    // the finishing order of the vertices (indexed from 1)
+    std::vector<int> order;
+    order.reserve(vertices(graph));
+    auto finished = [&order](int v) { order.push_back(v + 1); };
+
+    sorted_to_pointer(graph);
+    pointer_to_swap(graph);
+
+    DFS<decltype(nothing), decltype(finished)> first(graph, 1, nothing, finished);
+    first.run_forest(nothing);
+
+    swap_to_pointer(graph);
+    pointer_to_sorted(graph);
+
+    transpose(graph, payloads...);
+
+    // store the start of the adjacency array instead of the name, since we can't find it in the swapped representation
+    // the name can then be read from the start of the adjacency array (sinks don't have one, so we keep their name)
+    for (int &v : order)
+        if (!neighbours(graph, v).empty())
+            v = graph[v];
+
+    int components = 0;
+    auto assign = [&component, &components](int v) { component(v, components); };
+
+    sorted_to_pointer(graph);
+    pointer_to_swap(graph);
+
+    DFS<decltype(assign), decltype(nothing), ignore_edges, Tree &> second(graph, 1, assign, nothing, ignore_edges(),
+                                                                         tree_edge);
+    for (auto it = order.rbegin(); it != order.rend(); it++) {
+        int v = second.is_vertex(*it) ? *it : graph[*it];
+
+        if (!second.is_black(v)) {
+            second.run_tree(v, *it);
+            components++;
+        }
+    }
+    second.restore();
+
+    swap_to_pointer(graph);
+    pointer_to_sorted(graph);
+
+    transpose(graph, payloads...);
+
+    return components;
+}
+
+/**
+ * Find the strongly connected components of the provided graph (see above).
+ *
+ * @param graph The graph in the sorted representation.
+ * @param component A custom user function that is called with each vertex (indexed from 0) and the index of its
+ *                  component. The components are numbered from 0 in the topological order of the condensation.
+ * @return The number of strongly connected components.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class F>
+int strongly_connected_components(std::vector<int> &graph, F &component) {
+    ignore_edges tree_edge;
+    return strongly_connected_components(graph, component, tree_edge);
+}
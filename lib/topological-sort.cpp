@@ -0,0 +1,36 @@
+#include <vector>
+#include <span>
+#include <optional>
+#include <stdexcept>
+#include "topological-sort.h"
+
+/**
+ * Store the topological order of the provided graph.
+ * If the graph contains a cycle, the order is the reverse of the DFS finishing order.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param order The span to store the vertices (indexed from 0) to. It must contain exactly one element per vertex.
+ * @return The first back edge found, or nothing if the graph is acyclic.
+ * @throws std::invalid_argument If the size of the span doesn't match the number of vertices, or if the graph has more
+ *                               than max_graph_size elements (the graph is unchanged).
+ */
+std::optional<edge> topological_sort(std::vector<int> &graph, std::span<int> order) {
+    if (order.size() != (std::size_t) vertices(graph))
+        throw std::invalid_argument("the order must contain exactly one element per vertex");
+
+    int i = (int) order.size();
+    auto finished = [&order, &i](int v) { order[--i] = v; };
+    return topological_sort(graph, finished);
+}
+
+/**
+ * Return an edge closing a cycle in the provided graph (a back edge), or nothing if the graph is acyclic.
+ * The rest of the cycle is the path from its target to its source in the DFS tree.
+ *
+ * @param graph The graph in the sorted representation.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+std::optional<edge> find_cycle(std::vector<int> &graph) {
+    auto nothing = [](int) {};
+    return topological_sort(graph, nothing);
+}
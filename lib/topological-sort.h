@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <optional>
+#include <concepts>
+#include "dfs-constant-memory.h"
+#include "utilities.h"
+
+/**
+ * Run a DFS over the entire provided graph, calling a function each time a vertex is closed.
+ * For a DAG, this is the reverse of a topological order.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param finished A custom user function that is called each time a vertex is closed.
+ * @param tree_edge A custom user function that is called with the vertex (indexed from 0) and the index of the edge
+ *                  (see DFS) each time a vertex is discovered. The roots of the DFS forest aren't discovered by edges.
+ * @return The first back edge found, or nothing if the graph is acyclic.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class F, class Tree> requires std::invocable<F &, int>
+std::optional<edge> topological_sort(std::vector<int> &graph, F &finished, Tree &tree_edge) {
+    std::optional<edge> back_edge;
+    auto nothing = [](int) {};
+    auto found = [&back_edge](int from, int to, int index) {
+        back_edge = edge{from, to, index};
+        return false;  // only the first back edge is reported
+    };
+
+    check_graph_size(graph);
+    sorted_to_pointer(graph);
+    pointer_to_swap(graph);
+
+    DFS<decltype(nothing), F, decltype(found), Tree &> dfs(graph, 1, nothing, finished, found, tree_edge);
+    dfs.run_forest(nothing);
+
+    swap_to_pointer(graph);
+    pointer_to_sorted(graph);
+
+    return back_edge;
+}
+
+/**
+ * Run a DFS over the entire provided graph, calling a function each time a vertex is closed.
+ * For a DAG, this is the reverse of a topological order.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param finished A custom user function that is called each time a vertex is closed.
+ * @return The first back edge found, or nothing if the graph is acyclic.
+ * @throws std::invalid_argument If the graph has more than max_graph_size elements (the graph is unchanged).
+ */
+template<class F> requires std::invocable<F &, int>
+std::optional<edge> topological_sort(std::vector<int> &graph, F &finished) {
+    ignore_edges tree_edge;
+    return topological_sort(graph, finished, tree_edge);
+}
+
+std::optional<edge> topological_sort(std::vector<int> &graph, std::span<int> order);
+
+std::optional<edge> find_cycle(std::vector<int> &graph);
@@ -1,5 +1,7 @@
 #include <vector>
 #include <span>
+#include <algorithm>
+#include <cstdlib>
 #include "utilities.h"
 
 /**
@@ -75,21 +77,38 @@ void pointer_to_sorted(std::vector<int> &graph) {
  * Convert the swapped representation to the sorted representation, in-place.
  */
 void swap_to_sorted(std::vector<int> &graph) {
-    for (int i = vertices(graph) + 2; i < graph.size(); i++)
-        // n < A[i] (non-zero-degree vertices)
-        if (vertices(graph) < graph[i])
-            graph[i] = graph[graph[i]];
+    int n = vertices(graph);
+
+    // replace the pointers by the names of the vertices they point to (n < A[i] for non-zero-degree vertices)
+    // the names are negated, so loops can't be mistaken for the names at the starts of the adjacency arrays and a vertex
+    // whose first neighbour is itself can't be mistaken for a vertex of degree 0
+    for (int i = n + 2; i < (int) graph.size(); i++)
+        if (n < graph[i])
+            graph[i] = -graph[graph[i]];
 
-    for (int i = 1; i < vertices(graph) + 1; i++)
-        graph[i] = graph[graph[i]];
+    for (int i = 1; i < n + 1; i++)
+        if (n < graph[i])
+            graph[i] = -graph[graph[i]];
 
-    swap_to_pointer(graph);
+    // move the first neighbours back to the starts of the adjacency arrays (the same as swap_to_pointer)
+    int v = n;
+    for (int i = (int) graph.size() - 1; i >= n + 2; i--) {
+        while (v >= 1 && graph[v] == v) v--;
+
+        if (v >= 1 && graph[i] == v) {
+            graph[i] = graph[v];
+            graph[v] = i;
+            v--;
+        }
+
+        graph[i] = std::abs(graph[i]);
+    }
 
     // restore vertices of degree 0
     // TODO: explain that is is really important to iterate backwards!
     int i_hat = graph.size();
-    for (int i = vertices(graph); i >= 1; i--) {
+    for (int i = n; i >= 1; i--) {
         if (graph[i] == i) graph[i] = i_hat;
         else i_hat = graph[i];
     }
-}
\ No newline at end of file
+}
@@ -2,7 +2,17 @@
 
 #include <vector>
 #include <span>
+#include <utility>
 
+/**
+ * A directed edge of the graph, with both vertices indexed from 0.
+ * The index is the position of the edge among the neighbours in the sorted representation.
+ */
+struct edge {
+    int from, to, index;
+
+    bool operator==(const edge &) const = default;
+};
 
 /**
  * Return the number of nodes of the given graph.
@@ -26,3 +36,94 @@ void swap_to_pointer(std::vector<int> &graph);
 
 void swap_to_sorted(std::vector<int> &graph);
 
+// internal helpers, not a part of the interface
+namespace detail {
+/**
+ * Return the vertex (indexed from 1) whose neighbours contain index i of the graph.
+ * The offsets are searched using a branchless binary search, which is considerably faster on large graphs.
+ *
+ * @param offsets The offsets of the vertices of the graph in the sorted representation.
+ */
+inline int owner(std::span<int> offsets, int i) {
+    const int *base = offsets.data();
+    int length = (int) offsets.size();
+
+    while (length > 1) {
+        int half = length / 2;
+        base = (base[half] <= i) ? base + half : base;
+        length -= half;
+    }
+
+    return (int) (base - offsets.data()) + (*base <= i);
+}
+}
+
+/**
+ * Transpose the graph (reverse all of its edges), in-place.
+ *
+ * Each edge is first replaced by its position in the transposed graph. Since the edges are ordered by their source,
+ * the new neighbours of each vertex end up sorted. The edges are then moved to their new positions by following the
+ * cycles of the permutation, marking the placed ones by negating them. The source of an edge that is picked up along
+ * the way is found by searching the (old) vertex offsets.
+ *
+ * The edges are moved in-place, but the positions are counted in a separate vector of n + 1 ints, since the offsets
+ * in the graph are still needed to find the sources. The extra memory is thus O(n), which is small compared to the
+ * graph when m is much larger than n, but not constant.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param payloads Arrays of data of the edges, indexed by the index of the edge (its position among the neighbours in
+ *                 the sorted representation). They are permuted along with the edges.
+ */
+template<class... Payloads>
+void transpose(std::vector<int> &graph, Payloads &... payloads) {
+    int n = vertices(graph), size = (int) graph.size();
+    auto offsets = std::span<int>(graph).subspan(1, n);
+
+    // the position of the next edge of each vertex in the transposed graph (start with the in-degrees)
+    std::vector<int> next(n + 1, 0);
+    for (int i = n + 2; i < size; i++)
+        next[graph[i]]++;
+
+    next[0] = n + 2;
+    for (int v = 1; v <= n; v++)
+        next[v] += next[v - 1];
+
+    // shift by one, so next[v] is where the first edge to v goes
+    for (int v = n; v >= 1; v--)
+        next[v] = next[v - 1];
+
+    for (int i = n + 2; i < size; i++)
+        graph[i] = next[graph[i]]++;
+
+    for (int i = n + 2, v = 1; i < size; i++) {
+        // the source of the edge at i (iterating the offsets along with i is cheaper than searching them)
+        while (v < n && offsets[v] <= i) v++;
+
+        if (graph[i] < 0) continue;
+
+        // move the (reversed) edge to its position, picking up the one that was there, until we get back to i
+        // the payloads of the edge that is being moved are kept at i
+        int to = v;
+        int j = graph[i];
+        while (j != i) {
+            int next_j = graph[j];
+            int next_to = detail::owner(offsets, j);
+            graph[j] = -to;
+            (std::swap(payloads[i - (n + 2)], payloads[j - (n + 2)]), ...);
+
+            to = next_to;
+            j = next_j;
+        }
+        graph[i] = -to;
+    }
+
+    // next[v] is now the end of the edges of v, which is the start of the edges of v + 1
+    for (int v = n; v >= 2; v--)
+        graph[v] = next[v - 1];
+    if (n > 0)
+        graph[1] = n + 2;
+
+    // unmark the edges
+    for (int i = n + 2; i < size; i++)
+        graph[i] = -graph[i];
+}
@@ -0,0 +1,188 @@
+#include <bit>
+#include <vector>
+#include <thread>
+#include <climits>
+#include <algorithm>
+#include "validation.h"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+/**
+ * Check the 8 values starting at a, storing a bit mask of those outside of [lo, hi] and a bit mask of those that are
+ * not smaller than the next value (if strict) or that are larger than the next value (if not strict).
+ * Reads 9 values. Uses AVX2 or SSE2 when compiled with support for them.
+ */
+template<bool strict>
+static inline void check_block(const int *a, int lo, int hi, unsigned &outside, unsigned &descending) {
+#if defined(__AVX2__)
+    __m256i current = _mm256_loadu_si256((const __m256i *) a);
+    __m256i next = _mm256_loadu_si256((const __m256i *) (a + 1));
+
+    __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(lo), current),
+                                  _mm256_cmpgt_epi32(current, _mm256_set1_epi32(hi)));
+    __m256i desc = strict ? _mm256_xor_si256(_mm256_cmpgt_epi32(next, current), _mm256_set1_epi32(-1))
+                          : _mm256_cmpgt_epi32(current, next);
+
+    outside = _mm256_movemask_ps(_mm256_castsi256_ps(out));
+    descending = _mm256_movemask_ps(_mm256_castsi256_ps(desc));
+#elif defined(__SSE2__) || defined(_M_X64)
+    outside = descending = 0;
+    for (int half = 0; half < 2; half++) {
+        __m128i current = _mm_loadu_si128((const __m128i *) (a + 4 * half));
+        __m128i next = _mm_loadu_si128((const __m128i *) (a + 4 * half + 1));
+
+        __m128i out = _mm_or_si128(_mm_cmplt_epi32(current, _mm_set1_epi32(lo)),
+                                   _mm_cmpgt_epi32(current, _mm_set1_epi32(hi)));
+        __m128i desc = strict ? _mm_xor_si128(_mm_cmpgt_epi32(next, current), _mm_set1_epi32(-1))
+                              : _mm_cmpgt_epi32(current, next);
+
+        outside |= _mm_movemask_ps(_mm_castsi128_ps(out)) << (4 * half);
+        descending |= _mm_movemask_ps(_mm_castsi128_ps(desc)) << (4 * half);
+    }
+#else
+    outside = descending = 0;
+    for (int i = 0; i < 8; i++) {
+        outside |= (a[i] < lo || a[i] > hi) << i;
+        descending |= (strict ? a[i] >= a[i + 1] : a[i] > a[i + 1]) << i;
+    }
+#endif
+}
+
+/**
+ * Check the values at indexes [begin, end) of the graph. Each value must be in [lo, hi] and it must be smaller than
+ * (if strict) or at most (if not strict) the next value, unless the next value is at a boundary (the start of the
+ * neighbours of a vertex). The last value of the checked region (at index last - 1) is not compared to anything.
+ *
+ * @param boundary The first boundary after begin; boundaries are sorted and end with boundaries_end.
+ * @return The first error found, or no_error.
+ */
+template<bool strict>
+static validation_result check_region(const std::vector<int> &graph, std::size_t begin, std::size_t end,
+                                      std::size_t last, int lo, int hi, const int *boundary,
+                                      const int *boundaries_end, graph_error outside_error,
+                                      graph_error descending_error) {
+    const int *a = graph.data();
+
+    // process the bits of the masks from the lowest (the bits of outside take precedence)
+    auto first_error = [&](std::size_t i, unsigned outside, unsigned descending) -> validation_result {
+        for (unsigned bits = outside | descending; bits != 0; bits &= bits - 1) {
+            int b = std::countr_zero(bits);
+
+            if (outside & (1u << b))
+                return {outside_error, i + b};
+
+            // descending values are only fine if the next one is at a boundary
+            auto next = (long long) (i + b + 1);
+            while (boundary != boundaries_end && *boundary < next) boundary++;
+            if (boundary == boundaries_end || *boundary != next)
+                return {descending_error, i + b};
+        }
+
+        return {no_error, 0};
+    };
+
+    std::size_t i = begin;
+    for (; i + 8 <= end && i + 8 < last; i += 8) {
+        unsigned outside, descending;
+        check_block<strict>(a + i, lo, hi, outside, descending);
+
+        if (outside | descending) {
+            auto result = first_error(i, outside, descending);
+            if (!result.valid()) return result;
+        }
+    }
+
+    for (; i < end; i++) {
+        unsigned outside = a[i] < lo || a[i] > hi;
+        unsigned descending = i + 1 < last && (strict ? a[i] >= a[i + 1] : a[i] > a[i + 1]);
+
+        auto result = first_error(i, outside, descending);
+        if (!result.valid()) return result;
+    }
+
+    return {no_error, 0};
+}
+
+/**
+ * Check that the graph is in a valid sorted representation: its size matches the number of vertices and edges, the
+ * vertices point to increasing indexes of the neighbours and the neighbours of each vertex are sorted vertices.
+ * The checks use SIMD instructions (AVX2 or SSE2 if compiled with support for them). Vertices with a single neighbour
+ * and loops can be rejected as well; they are reported only if the graph is otherwise valid.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param threads The number of threads to check the neighbours with.
+ * @param degree_one Whether vertices can have a single neighbour.
+ * @param loops Whether vertices can be their own neighbours.
+ * @return The kind of the first error and the index in the graph at which it was found.
+ */
+validation_result validate_sorted(const std::vector<int> &graph, int threads, bool degree_one, bool loops) {
+    std::size_t size = graph.size();
+    if (size < 2 || size > INT_MAX)
+        return {invalid_size, 0};
+
+    int n = graph[0];
+    if (n < 0 || (std::size_t) n + 2 > size)
+        return {invalid_size, 0};
+
+    int m = graph[n + 1];
+    if (m < 0 || (std::size_t) n + m + 2 != size)
+        return {invalid_size, (std::size_t) n + 1};
+
+    if (n > 0 && graph[1] != n + 2)
+        return {invalid_offset, 1};
+
+    // the vertices
+    auto result = check_region<false>(graph, 1, n + 1, n + 1, n + 2, n + m + 2, nullptr, nullptr,
+                                      invalid_offset, unsorted_offsets);
+    if (!result.valid()) return result;
+
+    // the neighbours, whose boundaries are the (now valid) vertex offsets
+    const int *offsets = graph.data() + 1;
+    auto check_neighbours = [&](std::size_t begin, std::size_t end) {
+        const int *boundary = std::lower_bound(offsets, offsets + n, (long long) begin + 1);
+        return check_region<true>(graph, begin, end, size, 1, n, boundary, offsets + n,
+                                  invalid_neighbour, unsorted_neighbours);
+    };
+
+    if (threads <= 1) {
+        result = check_neighbours(n + 2, size);
+    } else {
+        std::size_t chunk = ((std::size_t) m + threads - 1) / threads;
+        std::vector<validation_result> results(threads, {no_error, 0});
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            std::size_t begin = std::min(size, n + 2 + t * chunk);
+            std::size_t end = std::min(size, begin + chunk);
+            workers.emplace_back([&, t, begin, end] { results[t] = check_neighbours(begin, end); });
+        }
+
+        for (auto &worker : workers)
+            worker.join();
+
+        // the chunks are ordered, so the first error is in the first invalid one
+        for (auto &r : results)
+            if (!r.valid()) { result = r; break; }
+    }
+
+    if (!result.valid() || (degree_one && loops))
+        return result;
+
+    // the vertices (whose indexes precede the neighbours) with a single neighbour, then the loops
+    auto end_of = [&](int v) { return v < n ? graph[v + 1] : (int) size; };
+    if (!degree_one)
+        for (int v = 1; v <= n; v++)
+            if (end_of(v) - graph[v] == 1)
+                return {forbidden_degree_one, (std::size_t) v};
+
+    if (!loops)
+        for (int v = 1; v <= n; v++) {
+            auto begin = graph.begin() + graph[v], end = graph.begin() + end_of(v);
+            auto loop = std::lower_bound(begin, end, v);
+            if (loop != end && *loop == v)
+                return {forbidden_loop, (std::size_t) (loop - graph.begin())};
+        }
+
+    return {no_error, 0};
+}
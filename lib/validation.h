@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * The kinds of errors that a graph in the sorted representation can contain.
+ */
+enum graph_error {
+    no_error,             // the graph is valid
+    invalid_size,         // the size of the graph doesn't match its number of vertices and edges
+    invalid_offset,       // a vertex points outside of the neighbours
+    unsorted_offsets,     // the vertices don't point to increasing indexes
+    invalid_neighbour,    // a neighbour is not a vertex
+    unsorted_neighbours,  // the neighbours of a vertex are not sorted (or contain duplicates)
+    forbidden_degree_one, // a vertex has a single neighbour, which was not allowed
+    forbidden_loop,       // a vertex is its own neighbour, which was not allowed
+};
+
+/**
+ * The result of validating a graph: the kind of the first error found and the index in the graph where it was found.
+ */
+struct validation_result {
+    graph_error error;
+    std::size_t index;
+
+    bool valid() const { return error == no_error; }
+
+    bool operator==(const validation_result &) const = default;
+};
+
+validation_result validate_sorted(const std::vector<int> &graph, int threads = 1, bool degree_one = true,
+                                  bool loops = true);
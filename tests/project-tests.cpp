@@ -1,5 +1,8 @@
 #include "../lib/dfs-linear-memory.h"
 #include "../lib/dfs-constant-memory.h"
+#include "../lib/topological-sort.h"
+#include "../lib/strongly-connected-components.h"
+#include "../lib/validation.h"
 #include "gtest/gtest.h"
 #include <queue>
 #include <stack>
@@ -143,6 +146,47 @@ generate_graph(int n, const std::set<int> &forbidden_degrees = std::set<int>(),
     return result;
 }
 
+/**
+ * A function that generates and returns a random DAG in the sorted representation.
+ * Vertices are randomly ordered and each one only has neighbours that come after it in this order.
+ *
+ * @param n The number of vertices.
+ * @param forbidden_degrees Nodes with the degrees from the vector will not be generated (if possible).
+ */
+std::vector<int> generate_dag(int n, const std::set<int> &forbidden_degrees = std::set<int>()) {
+    // the topological order of the vertices
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    for (int i = n - 1; i > 0; i--) std::swap(order[i], order[random(0, i + 1)]);
+
+    std::vector<std::vector<int>> adjacency(n);
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        // only the vertices after this one in the order can be neighbours
+        int remaining = n - i - 1;
+        int degree = random(0, remaining + 1);
+        while (forbidden_degrees.contains(degree) && degree != 0) degree = (degree + 1) % (remaining + 1);
+
+        std::set<int> neighbours;
+        while ((int) neighbours.size() < degree)
+            neighbours.insert(order[random(i + 1, n)]);
+
+        adjacency[order[i]] = std::vector<int>(neighbours.begin(), neighbours.end());
+        m += degree;
+    }
+
+    std::vector<int> result{n};
+    for (int v = 0, vertex_index = n + 2; v < n; vertex_index += (int) adjacency[v++].size())
+        result.push_back(vertex_index);
+
+    result.push_back(m);
+    for (auto &neighbours : adjacency)
+        for (int v : neighbours)
+            result.push_back(v + 1);
+
+    return result;
+}
+
 /**
  * Attach a formatted graph representation to a debug message.
  */
@@ -290,12 +334,12 @@ void check_dfs_order(std::vector<int> &graph, std::vector<int> order, int start)
             // check if all other children were explored
             // TODO: isn't this redundant?
             for (int neighbour : neighbours(graph, path.back())) {
-                ASSERT_TRUE(std::find(path.begin(), path.end(), neighbour) != path.end() || explored[neighbour]) << attach_graph(
+                ASSERT_TRUE(std::find(path.begin(), path.end(), neighbour) != path.end() || explored[neighbour - 1]) << attach_graph(
                                     "Postprocess was called on vertex " + std::to_string(abs(v)) + " before exploring its neighbour " +
                                     std::to_string(path.back()) + ":", graph);
             }
 
-            explored[path.back()] = true;
+            explored[path.back() - 1] = true;
             path.pop_back();
         }
     }
@@ -309,6 +353,87 @@ void check_dfs_order(std::vector<int> &graph, std::vector<int> order, int start)
                             "Preprocess and postprocess not called on " + std::to_string(order[i]) + ".", graph);
 }
 
+/**
+ * Check that the tree edges reported by the constant memory DFS are correct: the edge at the reported index must lead
+ * from the currently opened vertex to the discovered one.
+ */
+void check_tree_edges(std::vector<int> &graph, int start) {
+    int n = vertices(graph);
+
+    std::vector<int> path;
+    int discovered = -1;
+    auto pre = [&](int v) {
+        if (!path.empty()) {
+            EXPECT_EQ(discovered, v) << attach_graph("Vertex " + std::to_string(v + 1) + " was not discovered:", graph);
+        }
+        path.push_back(v);
+    };
+    auto post = [&path](int) { path.pop_back(); };
+    auto tree = [&](int v, int index) {
+        ASSERT_TRUE(0 <= index && index < edges(graph)) << attach_graph("Edge index out of range:", graph);
+
+        auto nb = neighbours(graph, path.back() + 1);
+        int position = n + 2 + index;
+        EXPECT_TRUE(graph[path.back() + 1] <= position && position < graph[path.back() + 1] + (int) nb.size())
+                            << attach_graph("Edge " + std::to_string(index) + " is not a neighbour of vertex " +
+                                            std::to_string(path.back() + 1) + ":", graph);
+        EXPECT_EQ(graph[position], v + 1) << attach_graph("Edge " + std::to_string(index) + " doesn't lead to vertex " +
+                                                          std::to_string(v + 1) + ":", graph);
+        discovered = v;
+    };
+
+    // the graph is in a different representation during the DFS, so run it on a copy
+    std::vector<int> copy(graph);
+    dfs_constant_memory(copy, start, pre, post, tree);
+
+    ASSERT_EQ(graph, copy) << "constant DFS with tree edges did not restore the graph.";
+
+    // the same with deferred restoration (the result is restored right away, since it is destroyed)
+    path.clear();
+    dfs_constant_memory_deferred(copy, start, pre, post, tree);
+
+    ASSERT_EQ(graph, copy) << "deferred DFS with tree edges did not restore the graph.";
+}
+
+/**
+ * Check that a DFS with deferred restoration reports exactly the vertices entered in the given order as visited, and
+ * that the graph is restored afterwards.
+ *
+ * @param graph The graph in the sorted representation.
+ * @param start The starting vertex (indexed from 0).
+ * @param order The order produced by a regular DFS from the same starting vertex (see check_dfs_order).
+ */
+void check_deferred_dfs(std::vector<int> &graph, int start, const std::vector<int> &order) {
+    auto graph_sorted(graph);
+
+    std::vector<bool> expected(vertices(graph));
+    for (int v : order) expected[abs(v) - 1] = true;
+
+    auto nothing = [](int) {};
+    {
+        auto dfs = dfs_constant_memory_deferred(graph, start, nothing, nothing);
+
+        for (int v = 0; v < vertices(graph); v++)
+            ASSERT_EQ(dfs.was_visited(v), expected[v]) << attach_graph(
+                                "Vertex " + std::to_string(v + 1) + " has an incorrect visited mark:", graph_sorted);
+
+        std::vector<bool> visited(vertices(graph));
+        auto mark = [&visited](int v) { visited[v] = true; };
+        dfs.for_each_visited(mark);
+        ASSERT_EQ(visited, expected) << attach_graph("The visited vertices were not iterated correctly:", graph_sorted);
+
+        dfs.restore();
+        ASSERT_EQ(graph_sorted, graph) << "deferred DFS did not restore the graph.";
+    }
+    ASSERT_EQ(graph_sorted, graph) << "deferred DFS changed the graph after being restored.";
+
+    // restoration on destruction
+    {
+        auto dfs = dfs_constant_memory_deferred(graph, start, nothing, nothing);
+    }
+    ASSERT_EQ(graph_sorted, graph) << "deferred DFS did not restore the graph on destruction.";
+}
+
 void test(int n_lo, int n_hi, const std::set<int> &forbidden_degrees = std::set<int>(), bool loops = false) {
     for (int i = 0; i < GENERATIONS; ++i) {
         // TEST GENERATION
@@ -352,6 +477,468 @@ void test(int n_lo, int n_hi, const std::set<int> &forbidden_degrees = std::set<
         dfs_constant_memory(graph, start, pre, post);
 
         check_dfs_order(graph, order, start + 1);
+        ASSERT_EQ(graph_sorted, graph) << "constant DFS did not restore the graph.";
+
+        // TEST DEFERRED RESTORATION
+        // -------------------------
+        check_deferred_dfs(graph, start, order);
+
+        // TEST TREE EDGES
+        // ---------------
+        check_tree_edges(graph, start);
+    }
+}
+
+/**
+ * Return the order in which the vertices are closed when running DFS from each unexplored vertex (in increasing order)
+ * using the linear memory DFS.
+ */
+std::vector<int> linear_memory_finish_order(std::vector<int> &graph) {
+    std::vector<int> order;
+    auto pre = [](int) {};
+    auto post = [&order](int v) { order.push_back(v); };
+
+    std::vector<state> states(vertices(graph), unexplored);
+    for (int v = 0; v < vertices(graph); v++) {
+        if (states[v] == unexplored) {
+            states[v] = explored;
+            dfs_linear_memory(graph, v, pre, post, states);
+        }
+    }
+
+    return order;
+}
+
+/**
+ * Return the index of the edge that each vertex is discovered by when running DFS from each unexplored vertex (in
+ * increasing order) using the linear memory DFS, or -1 for the roots.
+ */
+std::vector<int> linear_memory_tree_edges(std::vector<int> &graph) {
+    int n = vertices(graph);
+    std::vector<int> tree_edges(n, -1), path;
+
+    auto pre = [&](int v) {
+        if (!path.empty()) {
+            auto nb = neighbours(graph, path.back() + 1);
+            int position = graph[path.back() + 1] + (int) (std::lower_bound(nb.begin(), nb.end(), v + 1) - nb.begin());
+            tree_edges[v] = position - (n + 2);
+        }
+        path.push_back(v);
+    };
+    auto post = [&path](int) { path.pop_back(); };
+
+    std::vector<state> states(n, unexplored);
+    for (int v = 0; v < n; v++) {
+        if (states[v] == unexplored) {
+            states[v] = explored;
+            dfs_linear_memory(graph, v, pre, post, states);
+        }
+    }
+
+    return tree_edges;
+}
+
+/**
+ * Check the topological sort and cycle detection of the graph against the linear memory DFS.
+ */
+void check_topological_sort(std::vector<int> &graph) {
+    auto graph_sorted(graph);
+    int n = vertices(graph);
+
+    auto expected = linear_memory_finish_order(graph);
+
+    std::vector<int> finish_order;
+    auto finished = [&finish_order](int v) { finish_order.push_back(v); };
+    auto back_edge = topological_sort(graph, finished);
+
+    ASSERT_EQ(graph_sorted, graph) << "topological sort did not restore the graph.";
+    ASSERT_EQ(finish_order, expected) << attach_graph("The finishing order doesn't match the linear DFS:", graph);
+
+    // back edges are exactly the edges that don't go to a vertex that was closed sooner
+    std::vector<int> finish_time(n);
+    for (int i = 0; i < n; i++) finish_time[expected[i]] = i;
+
+    bool acyclic = true;
+    for (int v = 1; v <= n; v++)
+        for (int u : neighbours(graph, v))
+            if (finish_time[u - 1] >= finish_time[v - 1])
+                acyclic = false;
+
+    ASSERT_EQ(back_edge.has_value(), !acyclic) << attach_graph("The cycle detection is incorrect:", graph);
+
+    if (back_edge) {
+        auto nb = neighbours(graph, back_edge->from + 1);
+        ASSERT_TRUE(std::find(nb.begin(), nb.end(), back_edge->to + 1) != nb.end()) << attach_graph(
+                            "The back edge " + std::to_string(back_edge->from + 1) + " -> " +
+                            std::to_string(back_edge->to + 1) + " is not in the graph:", graph);
+
+        ASSERT_EQ(graph[n + 2 + back_edge->index], back_edge->to + 1) << attach_graph(
+                            "The back edge index doesn't lead to its target:", graph);
+        ASSERT_TRUE(graph[back_edge->from + 1] <= n + 2 + back_edge->index &&
+                    n + 2 + back_edge->index < graph[back_edge->from + 1] + (int) nb.size()) << attach_graph(
+                            "The back edge index isn't a neighbour of its source:", graph);
+
+        ASSERT_GE(finish_time[back_edge->to], finish_time[back_edge->from]) << attach_graph(
+                            "The edge " + std::to_string(back_edge->from + 1) + " -> " +
+                            std::to_string(back_edge->to + 1) + " is not a back edge:", graph);
+    }
+
+    ASSERT_EQ(find_cycle(graph), back_edge) << attach_graph("find_cycle doesn't match the topological sort:", graph);
+
+    std::vector<int> tree_edges(n, -1);
+    auto nothing = [](int) {};
+    auto tree = [&tree_edges](int v, int index) { tree_edges[v] = index; };
+    ASSERT_EQ(topological_sort(graph, nothing, tree), back_edge);
+    ASSERT_EQ(tree_edges, linear_memory_tree_edges(graph)) << attach_graph(
+                        "The tree edges don't match the linear DFS:", graph);
+
+    std::vector<int> order(n);
+    ASSERT_EQ(topological_sort(graph, std::span<int>(order)), back_edge);
+    ASSERT_TRUE(std::equal(order.begin(), order.end(), expected.rbegin())) << attach_graph(
+                        "The topological order isn't the reverse of the finishing order:", graph);
+    ASSERT_EQ(graph_sorted, graph) << "topological sort did not restore the graph.";
+}
+
+void test_topological_sort(int n_lo, int n_hi, const std::set<int> &forbidden_degrees, bool dag, bool loops = false) {
+    for (int i = 0; i < GENERATIONS; ++i) {
+        auto graph = dag
+                     ? generate_dag(random(n_lo, n_hi), forbidden_degrees)
+                     : generate_random_graph(n_lo, n_hi, forbidden_degrees, loops);
+
+        check_graph_correctness(graph, vertices(graph), edges(graph), forbidden_degrees, loops);
+        check_topological_sort(graph);
+    }
+}
+
+/**
+ * Return the transposed graph, built using additional memory.
+ */
+std::vector<int> transposed(std::vector<int> &graph) {
+    int n = vertices(graph);
+    std::vector<std::vector<int>> adjacency(n);
+    for (int v = 1; v <= n; v++)
+        for (int u : neighbours(graph, v))
+            adjacency[u - 1].push_back(v);
+
+    std::vector<int> result{n};
+    for (int v = 0, vertex_index = n + 2; v < n; vertex_index += (int) adjacency[v++].size())
+        result.push_back(vertex_index);
+
+    result.push_back(edges(graph));
+    for (auto &nb : adjacency)
+        result.insert(result.end(), nb.begin(), nb.end());
+
+    return result;
+}
+
+/**
+ * The recursive part of Tarjan's algorithm (see tarjan_components).
+ */
+void tarjan(std::vector<int> &graph, int v, std::vector<int> &index, std::vector<int> &low, std::vector<bool> &on_stack,
+            std::stack<int> &stack, std::vector<int> &components, int &next_index, int &next_component) {
+    index[v] = low[v] = next_index++;
+    stack.push(v);
+    on_stack[v] = true;
+
+    for (int u : neighbours(graph, v + 1)) {
+        if (index[u - 1] == -1) {
+            tarjan(graph, u - 1, index, low, on_stack, stack, components, next_index, next_component);
+            low[v] = std::min(low[v], low[u - 1]);
+        } else if (on_stack[u - 1]) {
+            low[v] = std::min(low[v], index[u - 1]);
+        }
+    }
+
+    if (low[v] == index[v]) {
+        int u;
+        do {
+            u = stack.top();
+            stack.pop();
+            on_stack[u] = false;
+            components[u] = next_component;
+        } while (u != v);
+
+        next_component++;
+    }
+}
+
+/**
+ * Return the strongly connected component of each vertex, computed by Tarjan's algorithm using linear memory.
+ */
+std::vector<int> tarjan_components(std::vector<int> &graph) {
+    int n = vertices(graph);
+    std::vector<int> index(n, -1), low(n), components(n);
+    std::vector<bool> on_stack(n);
+    std::stack<int> stack;
+
+    int next_index = 0, next_component = 0;
+    for (int v = 0; v < n; v++)
+        if (index[v] == -1)
+            tarjan(graph, v, index, low, on_stack, stack, components, next_index, next_component);
+
+    return components;
+}
+
+/**
+ * Check the in-place transposition and the strongly connected components of the graph.
+ */
+void check_strongly_connected_components(std::vector<int> &graph) {
+    auto graph_sorted(graph);
+    int n = vertices(graph);
+
+    auto expected_transpose = transposed(graph);
+    transpose(graph);
+    ASSERT_EQ(graph, expected_transpose) << attach_graph("The graph was not transposed correctly:", graph_sorted);
+    transpose(graph);
+    ASSERT_EQ(graph, graph_sorted) << "transposing twice produced a different graph.";
+
+    // the components are only equal up to renaming, so compare which vertices share them
+    auto expected = tarjan_components(graph);
+
+    std::vector<int> components(n, -1);
+    auto component = [&components](int v, int c) { components[v] = c; };
+    int count = strongly_connected_components(graph, component);
+
+    ASSERT_EQ(graph, graph_sorted) << "strongly connected components did not restore the graph.";
+    ASSERT_EQ(count, expected.empty() ? 0 : *std::max_element(expected.begin(), expected.end()) + 1)
+                                << attach_graph("Incorrect number of strongly connected components:", graph);
+
+    for (int u = 0; u < n; u++)
+        for (int v = 0; v < n; v++)
+            ASSERT_EQ(components[u] == components[v], expected[u] == expected[v]) << attach_graph(
+                                "Vertices " + std::to_string(u + 1) + " and " + std::to_string(v + 1) +
+                                " are assigned to incorrect components:", graph);
+
+    // the components should be in topological order
+    for (int v = 1; v <= n; v++)
+        for (int u : neighbours(graph, v))
+            ASSERT_LE(components[v - 1], components[u - 1]) << attach_graph(
+                                "The components are not in topological order:", graph);
+
+    // the tree edges, with the source and the target of each edge as its payloads
+    int m = edges(graph);
+    std::vector<int> sources(m), targets(m);
+    for (int v = 1; v <= n; v++)
+        for (int i = graph[v]; i < graph[v] + (int) neighbours(graph, v).size(); i++) {
+            sources[i - n - 2] = v;
+            targets[i - n - 2] = graph[i];
+        }
+    auto sources_sorted(sources), targets_sorted(targets);
+
+    std::vector<int> tree_sources(n, -1), tree_targets(n, -1);
+    auto tree = [&](int v, int index) {
+        // the payloads are transposed along with the graph, so they still describe the edge in the original graph
+        tree_sources[v] = sources[index] - 1;
+        tree_targets[v] = targets[index] - 1;
+    };
+    ASSERT_EQ(strongly_connected_components(graph, component, tree, sources, targets), count);
+
+    ASSERT_EQ(graph, graph_sorted) << "strongly connected components did not restore the graph.";
+    ASSERT_EQ(sources, sources_sorted) << "strongly connected components did not restore the payloads.";
+    ASSERT_EQ(targets, targets_sorted) << "strongly connected components did not restore the payloads.";
+
+    // each vertex but the first one of each component is discovered by an edge (reversed) from the same component
+    int roots = 0;
+    for (int v = 0; v < n; v++) {
+        if (tree_sources[v] == -1) {
+            roots++;
+            continue;
+        }
+
+        ASSERT_EQ(tree_sources[v], v) << attach_graph("The tree edge of vertex " + std::to_string(v + 1) +
+                                                      " doesn't lead from it in the original graph:", graph);
+        ASSERT_EQ(components[tree_targets[v]], components[v]) << attach_graph(
+                            "The tree edge of vertex " + std::to_string(v + 1) + " leaves its component:", graph);
+    }
+    ASSERT_EQ(roots, count) << attach_graph("Incorrect number of vertices not discovered by a tree edge:", graph);
+}
+
+/**
+ * Check that transposing the graph permutes the payload arrays along with the edges.
+ */
+void check_transpose_payloads(std::vector<int> &graph) {
+    auto graph_sorted(graph);
+    int n = vertices(graph), m = edges(graph);
+
+    // store the source and the target of each edge as its payload (of different types, to check both)
+    std::vector<long long> sources(m);
+    std::vector<int> targets(m);
+    for (int v = 1; v <= n; v++)
+        for (int i = graph[v]; i < graph[v] + (int) neighbours(graph, v).size(); i++) {
+            sources[i - n - 2] = v;
+            targets[i - n - 2] = graph[i];
+        }
+
+    transpose(graph, sources, targets);
+
+    for (int v = 1; v <= n; v++)
+        for (int i = graph[v]; i < graph[v] + (int) neighbours(graph, v).size(); i++) {
+            ASSERT_EQ(sources[i - n - 2], graph[i]) << attach_graph("The payload was not transposed correctly:",
+                                                                    graph_sorted);
+            ASSERT_EQ(targets[i - n - 2], v) << attach_graph("The payload was not transposed correctly:", graph_sorted);
+        }
+
+    transpose(graph, sources, targets);
+    ASSERT_EQ(graph, graph_sorted) << "transposing twice produced a different graph.";
+}
+
+/**
+ * Check the strongly connected components of generated graphs.
+ *
+ * @param sparse Whether to generate graphs with at most 2n edges, which have many small components.
+ */
+void test_strongly_connected_components(int n_lo, int n_hi, bool dag, bool sparse = false, bool loops = false) {
+    for (int i = 0; i < GENERATIONS; ++i) {
+        int n = random(n_lo, n_hi);
+        auto graph = dag
+                     ? generate_dag(n)
+                     : sparse
+                       ? generate_graph(n, random(0, 2 * n + 1), loops)
+                       : generate_random_graph(n_lo, n_hi, std::set<int>(), loops);
+
+        check_transpose_payloads(graph);
+        check_strongly_connected_components(graph);
+    }
+}
+
+/**
+ * Check that validating the graph (with one and with multiple threads) produces the expected result.
+ */
+void check_validation(const std::vector<int> &graph, validation_result expected, bool degree_one = true,
+                      bool loops = true) {
+    for (int threads : {1, 4}) {
+        auto result = validate_sorted(graph, threads, degree_one, loops);
+        ASSERT_EQ(result.error, expected.error) << attach_graph(
+                            "Validation with " + std::to_string(threads) + " threads found a different error:", graph);
+        ASSERT_EQ(result.index, expected.index) << attach_graph(
+                            "Validation with " + std::to_string(threads) + " threads found the error elsewhere:", graph);
+    }
+}
+
+/**
+ * Validate the graph and its corruptions, each containing a single error at a known index.
+ */
+void check_validate_sorted(std::vector<int> &graph) {
+    int n = vertices(graph), m = edges(graph);
+    check_validation(graph, {no_error, 0});
+
+    // an extra value or a missing one
+    auto corrupted(graph);
+    corrupted.push_back(1);
+    check_validation(corrupted, {invalid_size, (std::size_t) n + 1});
+    corrupted.pop_back();
+    corrupted.pop_back();
+    check_validation(corrupted, {invalid_size, m > 0 ? (std::size_t) n + 1 : 0});
+
+    // a neighbour that is not a vertex (first/last, so the neighbours stay sorted)
+    for (int v = 1; v <= n; v++) {
+        int degree = (int) neighbours(graph, v).size();
+        if (degree == 0)
+            continue;
+
+        corrupted = graph;
+        corrupted[graph[v]] = 0;
+        check_validation(corrupted, {invalid_neighbour, (std::size_t) graph[v]});
+
+        corrupted = graph;
+        corrupted[graph[v] + degree - 1] = n + 1;
+        check_validation(corrupted, {invalid_neighbour, (std::size_t) graph[v] + degree - 1});
+    }
+
+    // swapped and duplicate neighbours of a vertex
+    for (int v = 1; v <= n; v++) {
+        if (neighbours(graph, v).size() < 2)
+            continue;
+
+        int i = graph[v];
+        corrupted = graph;
+        std::swap(corrupted[i], corrupted[i + 1]);
+        check_validation(corrupted, {unsorted_neighbours, (std::size_t) i});
+
+        corrupted = graph;
+        corrupted[i + 1] = corrupted[i];
+        check_validation(corrupted, {unsorted_neighbours, (std::size_t) i});
+    }
+
+    // swapped vertices and a vertex that points outside the neighbours
+    for (int v = 2; v < n; v++) {
+        if (graph[v] == graph[v + 1])
+            continue;
+
+        corrupted = graph;
+        std::swap(corrupted[v], corrupted[v + 1]);
+        check_validation(corrupted, {unsorted_offsets, (std::size_t) v});
+    }
+
+    if (n > 0) {
+        corrupted = graph;
+        corrupted[n] = n + m + 3;
+        check_validation(corrupted, {invalid_offset, (std::size_t) n});
+
+        corrupted = graph;
+        corrupted[1] = n + 3;
+        check_validation(corrupted, {invalid_offset, 1});
+    }
+
+    // the first vertex with a single neighbour and the first loop, when they are not allowed
+    validation_result degree_one{no_error, 0}, loop{no_error, 0};
+    for (int v = n; v >= 1; v--) {
+        auto adjacent = neighbours(graph, v);
+        if (adjacent.size() == 1)
+            degree_one = {forbidden_degree_one, (std::size_t) v};
+
+        auto position = std::find(adjacent.begin(), adjacent.end(), v);
+        if (position != adjacent.end())
+            loop = {forbidden_loop, (std::size_t) graph[v] + (position - adjacent.begin())};
+    }
+
+    check_validation(graph, degree_one, false, true);
+    check_validation(graph, loop, true, false);
+    check_validation(graph, degree_one.valid() ? loop : degree_one, false, false);
+}
+
+void test_validate_sorted(int n_lo, int n_hi, const std::set<int> &forbidden_degrees, bool loops) {
+    for (int i = 0; i < GENERATIONS; ++i) {
+        auto graph = generate_random_graph(n_lo, n_hi, forbidden_degrees, loops);
+        check_validate_sorted(graph);
+    }
+}
+
+TEST(ArrayTestSuite, TestUnreachableVertices) {
+    // vertex 4 is not reachable from vertex 1
+    std::vector<int> graph{4, 6, 8, 10, 12, 8, 2, 3, 1, 3, 1, 2, 1, 2};
+    auto graph_sorted(graph);
+
+    std::vector<int> order;
+    auto pre = [&order](int v) { order.push_back(v + 1); };
+    auto post = [&order](int v) { order.push_back(-v - 1); };
+    dfs_constant_memory(graph, 0, pre, post);
+
+    check_dfs_order(graph, order, 1);
+    ASSERT_EQ(graph_sorted, graph) << "constant DFS did not restore the unreachable vertices.";
+
+    check_deferred_dfs(graph, 0, order);
+}
+
+TEST(TopologicalSortTestSuite, TestDegreeOneVertices) {
+    // vertex 1 only has a single neighbour and closes a cycle through it
+    std::vector<int> graph{3, 5, 6, 8, 5, 2, 1, 3, 1, 2};
+    check_topological_sort(graph);
+
+    // a vertex whose only neighbour is itself is the simplest cycle
+    graph = {1, 3, 1, 1};
+    check_topological_sort(graph);
+    ASSERT_EQ(find_cycle(graph), (edge{0, 0, 0}));
+}
+
+TEST(TopologicalSortTestSuite, TestOrderSize) {
+    std::vector<int> graph{3, 5, 6, 8, 5, 2, 1, 3, 1, 2};
+    auto graph_sorted(graph);
+
+    for (int size : {0, 2, 4}) {
+        std::vector<int> order(size);
+        ASSERT_THROW(topological_sort(graph, std::span<int>(order)), std::invalid_argument);
+        ASSERT_EQ(graph_sorted, graph) << "topological sort changed the graph after rejecting the order.";
     }
 }
 
@@ -379,4 +966,70 @@ TEST(ArrayTestSuite, TestMediumAllDegrees) { test(MEDIUM); }
 #if LARGE_TESTS
 TEST(ArrayTestSuite, TestLargeAllDegrees) { test(LARGE); }
 #endif
-//@formatter:on
\ No newline at end of file
+
+TEST(ArrayTestSuite, TestSmallAllDegreesWithLoops) { test(SMALL, std::set<int>(), true); }
+TEST(ArrayTestSuite, TestMediumAllDegreesWithLoops) { test(MEDIUM, std::set<int>(), true); }
+#if LARGE_TESTS
+TEST(ArrayTestSuite, TestLargeAllDegreesWithLoops) { test(LARGE, std::set<int>(), true); }
+#endif
+
+TEST(TopologicalSortTestSuite, TestSmallDAGs) { test_topological_sort(SMALL, std::set<int>(), true); }
+TEST(TopologicalSortTestSuite, TestMediumDAGs) { test_topological_sort(MEDIUM, std::set<int>(), true); }
+#if LARGE_TESTS
+TEST(TopologicalSortTestSuite, TestLargeDAGs) { test_topological_sort(LARGE, std::set<int>(), true); }
+#endif
+
+TEST(TopologicalSortTestSuite, TestSmallGraphs) { test_topological_sort(SMALL, std::set<int>(), false); }
+TEST(TopologicalSortTestSuite, TestMediumGraphs) { test_topological_sort(MEDIUM, std::set<int>(), false); }
+#if LARGE_TESTS
+TEST(TopologicalSortTestSuite, TestLargeGraphs) { test_topological_sort(LARGE, std::set<int>(), false); }
+#endif
+
+TEST(TopologicalSortTestSuite, TestSmallGraphsWithLoops) { test_topological_sort(SMALL, std::set<int>(), false, true); }
+TEST(TopologicalSortTestSuite, TestMediumGraphsWithLoops) { test_topological_sort(MEDIUM, std::set<int>(), false, true); }
+#if LARGE_TESTS
+TEST(TopologicalSortTestSuite, TestLargeGraphsWithLoops) { test_topological_sort(LARGE, std::set<int>(), false, true); }
+#endif
+
+TEST(StronglyConnectedComponentsTestSuite, TestEmptyGraph) {
+    std::vector<int> graph{0, 0};
+    check_transpose_payloads(graph);
+    check_strongly_connected_components(graph);
+}
+
+TEST(StronglyConnectedComponentsTestSuite, TestSmallDAGs) { test_strongly_connected_components(SMALL, true); }
+TEST(StronglyConnectedComponentsTestSuite, TestMediumDAGs) { test_strongly_connected_components(MEDIUM, true); }
+#if LARGE_TESTS
+TEST(StronglyConnectedComponentsTestSuite, TestLargeDAGs) { test_strongly_connected_components(LARGE, true); }
+#endif
+
+TEST(StronglyConnectedComponentsTestSuite, TestSmallGraphs) { test_strongly_connected_components(SMALL, false); }
+TEST(StronglyConnectedComponentsTestSuite, TestMediumGraphs) { test_strongly_connected_components(MEDIUM, false); }
+#if LARGE_TESTS
+TEST(StronglyConnectedComponentsTestSuite, TestLargeGraphs) { test_strongly_connected_components(LARGE, false); }
+#endif
+
+TEST(StronglyConnectedComponentsTestSuite, TestSmallSparseGraphs) { test_strongly_connected_components(SMALL, false, true); }
+TEST(StronglyConnectedComponentsTestSuite, TestMediumSparseGraphs) { test_strongly_connected_components(MEDIUM, false, true); }
+#if LARGE_TESTS
+TEST(StronglyConnectedComponentsTestSuite, TestLargeSparseGraphs) { test_strongly_connected_components(LARGE, false, true); }
+#endif
+
+TEST(StronglyConnectedComponentsTestSuite, TestSmallSparseGraphsWithLoops) { test_strongly_connected_components(SMALL, false, true, true); }
+TEST(StronglyConnectedComponentsTestSuite, TestMediumSparseGraphsWithLoops) { test_strongly_connected_components(MEDIUM, false, true, true); }
+#if LARGE_TESTS
+TEST(StronglyConnectedComponentsTestSuite, TestLargeSparseGraphsWithLoops) { test_strongly_connected_components(LARGE, false, true, true); }
+#endif
+
+TEST(ValidationTestSuite, TestSmallGraphs) { test_validate_sorted(SMALL, std::set<int>(), false); }
+TEST(ValidationTestSuite, TestMediumGraphs) { test_validate_sorted(MEDIUM, std::set<int>(), false); }
+#if LARGE_TESTS
+TEST(ValidationTestSuite, TestLargeGraphs) { test_validate_sorted(LARGE, std::set<int>(), false); }
+#endif
+
+TEST(ValidationTestSuite, TestSmallGraphsWithLoops) { test_validate_sorted(SMALL, std::set{1}, true); }
+TEST(ValidationTestSuite, TestMediumGraphsWithLoops) { test_validate_sorted(MEDIUM, std::set{1}, true); }
+#if LARGE_TESTS
+TEST(ValidationTestSuite, TestLargeGraphsWithLoops) { test_validate_sorted(LARGE, std::set{1}, true); }
+#endif
+//@formatter:on